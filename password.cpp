@@ -7,9 +7,12 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <chrono>
+#include <map>
+#include <sys/stat.h> // For file size and last-write time
 #include <conio.h> // For masked input using getch()
 using namespace std;
 
@@ -35,6 +38,14 @@ const string master_file = "master.txt";
 const string db_file = "passwords.txt";
 const string export_file = "exported_passwords.txt";
 const string security_file = "security.txt";
+const string snapshot_file = "passwords.snap";
+
+// Compressed snapshot settings
+const string snapshot_magic = "PMSNAP3\n";
+const size_t snapshot_block_records = 16;   // Records per independently-decodable block
+const size_t snapshot_dict_limit = 4096;    // Max size of the shared dictionary in bytes
+const size_t lz_max_match = 131;            // Longest match, so a block grows at most 131x when decompressed
+bool snapshot_enabled = false;              // True when passwords.snap is kept in sync
 
 // Security questions for password recovery
 string security_questions[] = {
@@ -318,47 +329,645 @@ bool login() {
     return true;
 }
 
+// Turn one record into the "|"-separated line used by passwords.txt
+string format_record(const pass &p) {
+    stringstream ss;
+    ss << p.title << "|" << p.userinfo << "|" << p.encrypted << "|" 
+       << p.key << "|" << p.strength << "|" << p.hashed << "|" 
+       << p.timestamp << "|" << p.expiry_date;
+    return ss.str();
+}
+
+// Parse one "|"-separated line back into a record
+pass parse_record(const string &line) {
+    stringstream ss(line);
+    string title, userinfo, enc, hash, created, expiry;
+    char key;
+    int strength;
+    getline(ss, title, '|');
+    getline(ss, userinfo, '|');
+    getline(ss, enc, '|');
+    ss >> key;
+    ss.ignore();
+    ss >> strength;
+    ss.ignore();
+    getline(ss, hash, '|');
+    getline(ss, created, '|');
+    getline(ss, expiry);
+    
+    // If expiry is empty (old format), calculate it
+    if (expiry.empty()) {
+        expiry = calculate_expiry(time(0));
+    }
+    
+    return {title, userinfo, hash, enc, key, strength, created, expiry};
+}
+
+// Write a number using 7 bits per byte (small numbers take 1 byte)
+void put_varint(string &out, size_t v) {
+    while (v >= 128) {
+        out += char((v & 127) | 128);
+        v >>= 7;
+    }
+    out += char(v);
+}
+
+// Read a number written by put_varint from a string
+bool get_varint(const string &in, size_t &pos, size_t &v) {
+    v = 0;
+    for (int shift = 0; pos < in.size() && shift < 64; shift += 7) {
+        unsigned char b = in[pos++];
+        v |= size_t(b & 127) << shift;
+        if (!(b & 128)) return true;
+    }
+    return false;
+}
+
+// Read a number written by put_varint from a file
+bool read_varint(istream &f, size_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int b = f.get();
+        if (b == EOF) return false;
+        v |= size_t(b & 127) << shift;
+        if (!(b & 128)) return true;
+    }
+    return false;
+}
+
+// Build the shared dictionary from field values that repeat across records.
+// Most frequent values go last so matches against them get the shortest offsets.
+string build_dictionary(const vector<pass> &records) {
+    map<string, int> freq;
+    for (const pass &p : records) {
+        freq[p.title]++;
+        size_t at = p.userinfo.find('@');
+        if (at != string::npos) freq[p.userinfo.substr(at)]++;
+    }
+    
+    vector<pair<int, string>> common;
+    for (auto &kv : freq) {
+        if (kv.second >= 2) common.push_back({kv.second, kv.first});
+    }
+    sort(common.begin(), common.end());
+    
+    string dict;
+    for (auto it = common.rbegin(); it != common.rend(); ++it) {
+        if (dict.size() + it->second.size() > snapshot_dict_limit) continue;
+        dict = it->second + dict;
+    }
+    return dict;
+}
+
+// Compress one block with LZ77, using the shared dictionary as earlier history.
+// Output is a list of (literal count, literals, match length - 4, match offset).
+string lz_compress(const string &dict, const string &data) {
+    string buf = dict + data;
+    vector<int> head(1 << 14, -1), prev(buf.size(), -1);
+    
+    auto insert = [&](size_t i) {
+        if (i + 4 > buf.size()) return;
+        unsigned h = (unsigned char)buf[i] | (unsigned char)buf[i + 1] << 8
+                   | (unsigned char)buf[i + 2] << 16 | (unsigned)(unsigned char)buf[i + 3] << 24;
+        h = (h * 2654435761u) >> 18;
+        prev[i] = head[h];
+        head[h] = i;
+    };
+    
+    for (size_t i = 0; i < dict.size(); i++) insert(i);
+    
+    string out;
+    size_t i = dict.size(), lit_start = i;
+    while (i < buf.size()) {
+        size_t best_len = 0, best_off = 0;
+        insert(i);
+        int cand = prev[i];
+        for (int depth = 0; cand >= 0 && depth < 32; depth++) {
+            size_t len = 0;
+            while (len < lz_max_match && i + len < buf.size() && buf[cand + len] == buf[i + len]) len++;
+            if (len > best_len) {
+                best_len = len;
+                best_off = i - cand;
+            }
+            cand = prev[cand];
+        }
+        
+        if (best_len >= 4) {
+            put_varint(out, i - lit_start);
+            out.append(buf, lit_start, i - lit_start);
+            put_varint(out, best_len - 4);
+            put_varint(out, best_off);
+            for (size_t k = 1; k < best_len; k++) insert(i + k);
+            i += best_len;
+            lit_start = i;
+        } else {
+            i++;
+        }
+    }
+    put_varint(out, i - lit_start);
+    out.append(buf, lit_start, i - lit_start);
+    return out;
+}
+
+// Decompress one block made by lz_compress
+bool lz_decompress(const string &dict, const string &in, size_t raw_size, string &out) {
+    string buf(dict.size() + raw_size, '\0');
+    copy(dict.begin(), dict.end(), buf.begin());
+    size_t pos = 0, end = dict.size(), len, off;
+    while (pos < in.size()) {
+        if (!get_varint(in, pos, len) || len > in.size() - pos || len > buf.size() - end) return false;
+        copy(in.begin() + pos, in.begin() + pos + len, buf.begin() + end);
+        pos += len;
+        end += len;
+        if (pos == in.size()) break;
+        
+        if (!get_varint(in, pos, len) || !get_varint(in, pos, off)) return false;
+        len += 4;
+        if (off == 0 || off > end || len > buf.size() - end) return false;
+        for (size_t k = 0; k < len; k++, end++) buf[end] = buf[end - off]; // Matches may overlap
+    }
+    if (end != buf.size()) return false;
+    out = buf.substr(dict.size());
+    return true;
+}
+
+// Signed numbers are zigzag-encoded so small negatives also take 1 byte
+void put_signed(string &out, long long v) {
+    put_varint(out, ((unsigned long long)v << 1) ^ (unsigned long long)(v >> 63));
+}
+
+bool get_signed(const string &in, size_t &pos, long long &v) {
+    size_t u;
+    if (!get_varint(in, pos, u)) return false;
+    v = (long long)(u >> 1) ^ -(long long)(u & 1);
+    return true;
+}
+
+// Days since 1970-01-01 for a calendar date (works for any year)
+long long days_from_civil(long long y, int m, int d) {
+    y -= m <= 2;
+    long long era = (y >= 0 ? y : y - 399) / 400;
+    long long yoe = y - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Calendar date for a day count from days_from_civil
+void civil_from_days(long long z, long long &y, int &m, int &d) {
+    z += 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = yoe + era * 400 + (m <= 2);
+}
+
+const char* week_days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+const char* month_names[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                             "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+// Write a clock reading (seconds counted on the calendar, no time zone)
+// in the same layout ctime() uses, e.g. "Mon Oct 19 14:22:01 2026"
+string format_ctime(long long secs) {
+    long long days = secs >= 0 ? secs / 86400 : -((-secs + 86399) / 86400);
+    long long rem = secs - days * 86400, y;
+    int m, d;
+    civil_from_days(days, y, m, d);
+    int wday = ((days + 4) % 7 + 7) % 7; // 1970-01-01 was a Thursday
+    if (y < 1000 || y > 9999) return "";
+    
+    // Filled by hand: this runs twice per record when loading a snapshot
+    string t = "Www Mmm dd hh:mm:ss yyyy";
+    int fields[] = {d, (int)(rem / 3600), (int)(rem / 60 % 60), (int)(rem % 60)};
+    t.replace(0, 3, week_days[wday]);
+    t.replace(4, 3, month_names[m - 1]);
+    for (int i = 0; i < 4; i++) {
+        t[8 + i * 3] = '0' + fields[i] / 10;
+        t[9 + i * 3] = '0' + fields[i] % 10;
+    }
+    if (d < 10) t[8] = ' ';
+    for (int i = 3; i >= 0; i--, y /= 10) t[20 + i] = '0' + y % 10;
+    return t;
+}
+
+// Read a ctime() string as a clock reading. Only succeeds when format_ctime
+// gives back exactly the same text, so storing the number is lossless.
+bool parse_ctime(const string &s, long long &secs) {
+    char wday[4], mon[4];
+    int d, hh, mm, ss;
+    long long y;
+    if (sscanf(s.c_str(), "%3s %3s %d %d:%d:%d %lld", wday, mon, &d, &hh, &mm, &ss, &y) != 7) {
+        return false;
+    }
+    if (y < 1000 || y > 9999 || d < 1 || d > 31 || hh < 0 || hh > 23 ||
+        mm < 0 || mm > 59 || ss < 0 || ss > 59) return false;
+    int m = 0;
+    while (m < 12 && string(month_names[m]) != mon) m++;
+    if (m == 12) return false;
+    
+    secs = days_from_civil(y, m + 1, d) * 86400 + hh * 3600 + mm * 60 + ss;
+    return format_ctime(secs) == s;
+}
+
+// Length-prefixed string
+void put_string(string &out, const string &s) {
+    put_varint(out, s.size());
+    out += s;
+}
+
+bool get_string(const string &in, size_t &pos, string &s) {
+    size_t len;
+    if (!get_varint(in, pos, len) || len > in.size() - pos) return false;
+    s = in.substr(pos, len);
+    pos += len;
+    return true;
+}
+
+// Lay out a block column by column (all titles, then all users, ...) so
+// similar values sit next to each other. Fields that can be rebuilt exactly
+// are stored in short form, with a tag saying which form was used:
+//   hashed    - 0 if it equals hash_string(decrypted), else 1 + the string
+//   timestamp - 1 + change from the previous record's time, else 0 + string
+//   expiry    - 1 + difference from timestamp + 90 days, else 0 + string
+string encode_block(const vector<pass> &records, size_t first, size_t last) {
+    const long long expiry_gap = 90 * 24 * 60 * 60;
+    vector<long long> created(last - first, 0);
+    vector<bool> created_ok(last - first, false);
+    string raw;
+    
+    for (int col = 0; col < 8; col++) {
+        long long prev = 0;
+        for (size_t i = first; i < last; i++) {
+            const pass &p = records[i];
+            long long t;
+            switch (col) {
+                case 0: put_string(raw, p.title); break;
+                case 1: put_string(raw, p.userinfo); break;
+                case 2: put_string(raw, p.encrypted); break;
+                case 3: raw += p.key; break;
+                case 4: put_varint(raw, p.strength); break;
+                case 5:
+                    if (p.hashed == hash_string(encrypt(p.encrypted, p.key))) {
+                        put_varint(raw, 0);
+                    } else {
+                        put_varint(raw, 1);
+                        put_string(raw, p.hashed);
+                    }
+                    break;
+                case 6:
+                    if (parse_ctime(p.timestamp, t)) {
+                        created[i - first] = t;
+                        created_ok[i - first] = true;
+                        put_varint(raw, 1);
+                        put_signed(raw, t - prev);
+                        prev = t;
+                    } else {
+                        put_varint(raw, 0);
+                        put_string(raw, p.timestamp);
+                    }
+                    break;
+                case 7:
+                    if (created_ok[i - first] && parse_ctime(p.expiry_date, t)) {
+                        put_varint(raw, 1);
+                        put_signed(raw, t - created[i - first] - expiry_gap);
+                    } else {
+                        put_varint(raw, 0);
+                        put_string(raw, p.expiry_date);
+                    }
+                    break;
+            }
+        }
+    }
+    return raw;
+}
+
+// Read back the records of a block written by encode_block
+bool decode_block(const string &raw, size_t count, vector<pass> &records) {
+    const long long expiry_gap = 90 * 24 * 60 * 60;
+    size_t first = records.size();
+    records.resize(first + count);
+    pass* block = &records[first];
+    vector<long long> created(count, 0);
+    vector<bool> created_ok(count, false);
+    size_t pos = 0, tag;
+    
+    for (int col = 0; col < 8; col++) {
+        long long prev = 0;
+        for (size_t i = 0; i < count; i++) {
+            pass &p = block[i];
+            long long delta;
+            bool ok = true;
+            switch (col) {
+                case 0: ok = get_string(raw, pos, p.title); break;
+                case 1: ok = get_string(raw, pos, p.userinfo); break;
+                case 2: ok = get_string(raw, pos, p.encrypted); break;
+                case 3:
+                    ok = pos < raw.size();
+                    if (ok) p.key = raw[pos++];
+                    break;
+                case 4:
+                    ok = get_varint(raw, pos, tag);
+                    p.strength = tag;
+                    break;
+                case 5:
+                    ok = get_varint(raw, pos, tag);
+                    if (ok && tag == 0) p.hashed = hash_string(encrypt(p.encrypted, p.key));
+                    else if (ok) ok = get_string(raw, pos, p.hashed);
+                    break;
+                case 6:
+                    ok = get_varint(raw, pos, tag);
+                    if (ok && tag == 1 && (ok = get_signed(raw, pos, delta))) {
+                        prev += delta;
+                        created[i] = prev;
+                        created_ok[i] = true;
+                        p.timestamp = format_ctime(prev);
+                    } else if (ok) {
+                        ok = get_string(raw, pos, p.timestamp);
+                    }
+                    break;
+                case 7:
+                    ok = get_varint(raw, pos, tag);
+                    if (ok && tag == 1 && (ok = created_ok[i] && get_signed(raw, pos, delta))) {
+                        p.expiry_date = format_ctime(created[i] + expiry_gap + delta);
+                    } else if (ok) {
+                        ok = get_string(raw, pos, p.expiry_date);
+                    }
+                    break;
+            }
+            if (!ok) return false;
+        }
+    }
+    return pos == raw.size();
+}
+
+// Everything needed to locate blocks inside passwords.snap
+struct snapshot_header {
+    size_t records = 0;
+    size_t block_records = 0;
+    size_t text_size = 0;       // Size of the passwords.txt this was saved with
+    long long text_mtime = 0;   // Last-write time of that passwords.txt
+    string dict;
+    vector<size_t> raw_sizes;   // Uncompressed size of each block
+    vector<size_t> comp_sizes;  // Compressed size of each block
+    vector<size_t> checksums;   // Checksum of each compressed block
+    vector<size_t> offsets;     // File offset of each block
+};
+
+// Size and last-write time of passwords.txt, read without opening the file
+// (0 and 0 if it does not exist yet)
+void text_file_info(size_t &size, long long &mtime) {
+    struct stat st;
+    size = 0;
+    mtime = 0;
+    if (stat(db_file.c_str(), &st) == 0) {
+        size = st.st_size;
+        mtime = st.st_mtime;
+    }
+}
+
+// FNV-1a checksum, used to spot damaged snapshot data
+size_t checksum(const string &s) {
+    unsigned h = 2166136261u;
+    for (char c : s) {
+        h ^= (unsigned char)c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Save all passwords as a compressed snapshot. Must run after passwords.txt
+// is written: the snapshot only counts as valid while that file is unchanged.
+// Layout: magic, header length, header checksum, header (counts, text size
+// and time, dictionary, block sizes and checksums), blocks.
+bool save_snapshot() {
+    size_t text_size;
+    long long text_mtime;
+    text_file_info(text_size, text_mtime);
+    vector<pass> records;
+    priority_queue<pass> temp = store;
+    while (!temp.empty()) {
+        records.push_back(temp.top());
+        temp.pop();
+    }
+    
+    string dict = build_dictionary(records);
+    vector<string> blocks;
+    vector<size_t> raw_sizes;
+    for (size_t i = 0; i < records.size(); i += snapshot_block_records) {
+        string raw = encode_block(records, i, min(records.size(), i + snapshot_block_records));
+        raw_sizes.push_back(raw.size());
+        blocks.push_back(lz_compress(dict, raw));
+    }
+    
+    string header;
+    put_varint(header, records.size());
+    put_varint(header, snapshot_block_records);
+    put_varint(header, text_size);
+    put_signed(header, text_mtime);
+    put_varint(header, dict.size());
+    header += dict;
+    put_varint(header, blocks.size());
+    for (size_t b = 0; b < blocks.size(); b++) {
+        put_varint(header, raw_sizes[b]);
+        put_varint(header, blocks[b].size());
+        put_varint(header, checksum(blocks[b]));
+    }
+    
+    string prefix;
+    put_varint(prefix, header.size());
+    put_varint(prefix, checksum(header));
+    
+    // Write to a temp file first so a crash never leaves a half-written snapshot
+    string temp_file = snapshot_file + ".tmp";
+    ofstream f(temp_file, ios::binary);
+    f << snapshot_magic << prefix << header;
+    for (const string &b : blocks) f << b;
+    f.close();
+    
+    // Keep the old snapshot unless the new one was written completely
+    if (!f) {
+        remove(temp_file.c_str());
+        cout << "Warning: could not write " << snapshot_file << endl;
+        return false;
+    }
+    
+    // rename() on Windows will not replace an existing file, so remove it first
+    remove(snapshot_file.c_str());
+    if (rename(temp_file.c_str(), snapshot_file.c_str()) != 0) {
+        cout << "Warning: could not write " << snapshot_file << endl;
+        return false;
+    }
+    return true;
+}
+
+// Read the snapshot header so blocks can be found without reading the rest.
+// Every size is checked against the file size before anything is allocated,
+// so a damaged file is rejected instead of crashing.
+bool read_snapshot_header(ifstream &f, snapshot_header &h) {
+    f.seekg(0, ios::end);
+    streamoff file_end = f.tellg();
+    f.seekg(0);
+    if (file_end < 0) return false;
+    size_t file_size = file_end;
+    
+    string magic(snapshot_magic.size(), '\0');
+    size_t header_size, header_checksum;
+    if (!f.read(&magic[0], magic.size()) || magic != snapshot_magic) return false;
+    if (!read_varint(f, header_size) || !read_varint(f, header_checksum)) return false;
+    if (header_size > file_size - (size_t)f.tellg()) return false;
+    
+    string header(header_size, '\0');
+    if (!f.read(&header[0], header_size) || checksum(header) != header_checksum) return false;
+    
+    size_t pos = 0, dict_size, block_count;
+    if (!get_varint(header, pos, h.records) || !get_varint(header, pos, h.block_records)) return false;
+    if (!get_varint(header, pos, h.text_size) || !get_signed(header, pos, h.text_mtime)) return false;
+    if (!get_varint(header, pos, dict_size) || dict_size > header.size() - pos) return false;
+    h.dict = header.substr(pos, dict_size);
+    pos += dict_size;
+    if (!get_varint(header, pos, block_count) || h.block_records != snapshot_block_records) return false;
+    
+    // Each block takes at least 2 bytes of header, which keeps the products below small
+    if (block_count > header.size()) return false;
+    if (h.records > block_count * h.block_records) return false;
+    if (h.records + h.block_records <= block_count * h.block_records) return false;
+    
+    size_t offset = f.tellg();
+    for (size_t b = 0; b < block_count; b++) {
+        size_t raw, comp, sum;
+        if (!get_varint(header, pos, raw) || !get_varint(header, pos, comp)) return false;
+        if (!get_varint(header, pos, sum)) return false;
+        if (comp > file_size - offset || raw / lz_max_match > comp) return false;
+        h.raw_sizes.push_back(raw);
+        h.comp_sizes.push_back(comp);
+        h.checksums.push_back(sum);
+        h.offsets.push_back(offset);
+        offset += comp;
+    }
+    return true;
+}
+
+// Check and decompress one block. A damaged block is rejected before decoding,
+// so bad records never reach the store (and from there passwords.txt).
+bool unpack_snapshot_block(const snapshot_header &h, size_t b, const string &comp, string &raw) {
+    if (checksum(comp) != h.checksums[b]) return false;
+    return lz_decompress(h.dict, comp, h.raw_sizes[b], raw);
+}
+
+// Read and decompress one block of the snapshot
+bool read_snapshot_block(ifstream &f, const snapshot_header &h, size_t b, string &raw) {
+    string comp(h.comp_sizes[b], '\0');
+    f.seekg(h.offsets[b]);
+    if (!f.read(&comp[0], comp.size())) return false;
+    return unpack_snapshot_block(h, b, comp, raw);
+}
+
+// Load every record from the compressed snapshot
+bool load_snapshot(vector<pass> &records) {
+    ifstream f(snapshot_file, ios::binary);
+    snapshot_header h;
+    if (!f.is_open() || !read_snapshot_header(f, h)) return false;
+    
+    // A snapshot older or newer than passwords.txt (the text file was restored
+    // or edited) must not be used. Only the file's size and time are compared,
+    // so startup does not read passwords.txt.
+    size_t text_size;
+    long long text_mtime;
+    text_file_info(text_size, text_mtime);
+    if (text_size != h.text_size || text_mtime != h.text_mtime) return false;
+    
+    // Read all blocks with one call, then decode them one by one
+    size_t total = 0;
+    for (size_t c : h.comp_sizes) total += c;
+    string data(total, '\0');
+    if (total > 0 && !f.read(&data[0], total)) return false;
+    
+    vector<pass> loaded;
+    loaded.reserve(h.records);
+    size_t pos = 0;
+    for (size_t b = 0; b < h.offsets.size(); b++) {
+        string raw;
+        size_t count = min(h.block_records, h.records - b * h.block_records);
+        if (!unpack_snapshot_block(h, b, data.substr(pos, h.comp_sizes[b]), raw)) return false;
+        if (!decode_block(raw, count, loaded)) return false;
+        pos += h.comp_sizes[b];
+    }
+    records.swap(loaded);
+    return true;
+}
+
+// Fetch a single record (0-based) by decompressing only the block holding it.
+// Only called right after save_snapshot(), so passwords.txt is not re-checked.
+bool fetch_snapshot_record(size_t index, pass &p) {
+    ifstream f(snapshot_file, ios::binary);
+    snapshot_header h;
+    if (!f.is_open() || !read_snapshot_header(f, h)) return false;
+    if (index >= h.records) return false;
+    
+    size_t b = index / h.block_records;
+    size_t count = min(h.block_records, h.records - b * h.block_records);
+    string raw;
+    vector<pass> block;
+    if (!read_snapshot_block(f, h, b, raw) || !decode_block(raw, count, block)) return false;
+    p = block[index % h.block_records];
+    return true;
+}
+
+// Spoil the snapshot's magic in place so it is rejected at startup. Used
+// before passwords.txt is rewritten: if the program dies before the new
+// snapshot is written, the old one cannot be loaded, even when the new
+// passwords.txt has the same size and time.
+void invalidate_snapshot() {
+    fstream f(snapshot_file, ios::in | ios::out | ios::binary);
+    if (f.is_open()) f << string(snapshot_magic.size(), '-');
+}
+
 // Save all passwords to file
 void save_passwords() {
+    if (snapshot_enabled) invalidate_snapshot();
+    
     ofstream f(db_file);
     priority_queue<pass> temp = store;
     while (!temp.empty()) {
         pass p = temp.top(); temp.pop();
-        f << p.title << "|" << p.userinfo << "|" << p.encrypted << "|" 
-          << p.key << "|" << p.strength << "|" << p.hashed << "|" 
-          << p.timestamp << "|" << p.expiry_date << endl;
+        f << format_record(p) << endl;
     }
     f.close();
+    
+    // Keep the compressed snapshot in sync when it is turned on
+    if (snapshot_enabled) save_snapshot();
 }
 
-// Load all passwords from file
-void load_passwords() {
+// Read all records from passwords.txt
+vector<pass> read_text_records() {
+    vector<pass> records;
     ifstream f(db_file);
     string line;
     while (getline(f, line)) {
-        stringstream ss(line);
-        string title, userinfo, enc, hash, time, expiry;
-        char key;
-        int strength;
-        getline(ss, title, '|');
-        getline(ss, userinfo, '|');
-        getline(ss, enc, '|');
-        ss >> key;
-        ss.ignore();
-        ss >> strength;
-        ss.ignore();
-        getline(ss, hash, '|');
-        getline(ss, time, '|');
-        getline(ss, expiry);
-        
-        // If expiry is empty (old format), calculate it
-        if (expiry.empty()) {
-            expiry = calculate_expiry(time(0));
-        }
-        
-        store.push({title, userinfo, hash, enc, key, strength, time, expiry});
+        records.push_back(parse_record(line));
     }
     f.close();
+    return records;
+}
+
+// Load all passwords from file (snapshot first if it is turned on)
+void load_passwords() {
+    vector<pass> records;
+    snapshot_enabled = ifstream(snapshot_file).good();
+    
+    // Fall back to the text file if the snapshot is missing or damaged
+    if (!snapshot_enabled || !load_snapshot(records)) {
+        if (snapshot_enabled) {
+            cout << "Warning: " << snapshot_file << " is out of date or damaged, loading "
+                 << db_file << " instead" << endl;
+        }
+        records = read_text_records();
+    }
+    for (auto &p : records) store.push(p);
 }
 
 // Add new password entry
@@ -613,6 +1222,103 @@ void export_passwords() {
     cout << "WARNING: This file contains unencrypted passwords. Keep it secure!" << endl;
 }
 
+// Size of a file in bytes (0 if missing)
+size_t file_size(const string &name) {
+    ifstream f(name, ios::binary | ios::ate);
+    if (!f.is_open()) return 0;
+    return f.tellg();
+}
+
+// Compare passwords.txt and passwords.snap by size and load time
+void compare_snapshot() {
+    const int runs = 100;
+    size_t text_size = file_size(db_file);
+    size_t snap_size = file_size(snapshot_file);
+    
+    auto start = chrono::steady_clock::now();
+    size_t count = 0;
+    for (int i = 0; i < runs; i++) count = read_text_records().size();
+    auto text_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / runs;
+    
+    start = chrono::steady_clock::now();
+    vector<pass> records;
+    for (int i = 0; i < runs; i++) load_snapshot(records);
+    auto snap_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / runs;
+    
+    pass p;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < runs && count > 0; i++) fetch_snapshot_record(count - 1, p);
+    auto fetch_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / runs;
+    
+    cout << "\nRecords: " << count << " (average of " << runs << " runs)\n";
+    cout << string(50, '-') << endl;
+    cout << left << setw(20) << "" << setw(15) << "Size (bytes)" << setw(15) << "Load (us)" << endl;
+    cout << left << setw(20) << db_file << setw(15) << text_size << setw(15) << text_us << endl;
+    cout << left << setw(20) << snapshot_file << setw(15) << snap_size << setw(15) << snap_us << endl;
+    cout << left << setw(20) << "Fetch last record" << setw(15) << "-" << setw(15) << fetch_us << endl;
+    cout << string(50, '-') << endl;
+    if (snap_size > 0) {
+        cout << "Compression ratio = " << fixed << setprecision(2)
+             << (double)text_size / snap_size << "x" << endl;
+        cout.unsetf(ios::fixed);
+    }
+}
+
+// Show one record (numbered as in View) by decompressing only its block
+void fetch_record() {
+    size_t n;
+    cout << "Enter record number (as listed in View, starting at 1) = ";
+    cin >> n;
+    
+    pass p;
+    if (n == 0 || !fetch_snapshot_record(n - 1, p)) {
+        cout << "No such record in " << snapshot_file << endl;
+        return;
+    }
+    cout << "Title: " << p.title << endl;
+    cout << "User: " << p.userinfo << endl;
+    cout << "Strength: " << p.strength << "/7 " << strength_level(p.strength) << endl;
+    cout << "Status: " << check_expiry(p.expiry_date) << endl;
+    cout << "Key: " << p.key << endl;
+    cout << "Created: " << p.timestamp << endl;
+}
+
+// Compressed snapshot options
+void snapshot_menu() {
+    int ch;
+    cout << "\nCompressed snapshot is " << (snapshot_enabled ? "ON" : "OFF") << endl;
+    cout << "1 = Turn on (keep " << snapshot_file << " in sync)\n";
+    cout << "2 = Turn off (delete " << snapshot_file << ")\n";
+    cout << "3 = Compare size and load time\n";
+    cout << "4 = Fetch one record\n";
+    cout << "Enter your choice = ";
+    cin >> ch;
+    
+    switch (ch) {
+        case 1:
+            snapshot_enabled = save_snapshot();
+            if (snapshot_enabled) cout << "Snapshot saved. It will be loaded at startup." << endl;
+            break;
+        case 2:
+            snapshot_enabled = false;
+            remove(snapshot_file.c_str());
+            cout << "Snapshot turned off. Using " << db_file << " only." << endl;
+            break;
+        case 3:
+        case 4:
+            // Write a fresh snapshot so both files hold the same records
+            if (!save_snapshot()) break;
+            if (ch == 3) compare_snapshot();
+            else fetch_record();
+            
+            // A snapshot left on disk turns the format on at next startup
+            if (!snapshot_enabled) remove(snapshot_file.c_str());
+            break;
+        default:
+            cout << "Invalid choice" << endl;
+    }
+}
+
 // Main program
 int main() {
     srand(time(0));
@@ -639,6 +1345,7 @@ int main() {
         cout << "7 = Search Passwords\n";
         cout << "8 = Export All Passwords\n";
         cout << "9 = Exit\n";
+        cout << "10 = Compressed Snapshot\n";
         cout << "========================================\n";
         cout << "Enter your choice = ";
         cin >> ch;
@@ -655,6 +1362,7 @@ int main() {
             case 9:
                 cout << "Exiting password manager. Goodbye!" << endl;
                 return 0;
+            case 10: snapshot_menu(); break;
             default:
                 cout << "Invalid choice. Try again" << endl;
         }